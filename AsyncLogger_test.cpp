@@ -0,0 +1,225 @@
+#include "async_logger.h"
+#include <gtest/gtest.h>  // Google Test框架
+#include <fcntl.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <sstream>
+#include <string>
+
+class AsyncLoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        file_ = tmpfile();
+        ASSERT_NE(file_, nullptr);
+    }
+
+    void TearDown() override {
+        fclose(file_);
+    }
+
+    int fd() const {
+        return fileno(file_);
+    }
+
+    // 读回已写出的全部行
+    std::vector<std::string> readLines() const {
+        std::string content;
+        char buf[4096];
+        ssize_t n;
+        off_t offset = 0;
+        while ((n = pread(fileno(file_), buf, sizeof(buf), offset)) > 0) {
+            content.append(buf, n);
+            offset += n;
+        }
+        std::vector<std::string> lines;
+        std::istringstream in(content);
+        std::string line;
+        while (std::getline(in, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    FILE* file_ = nullptr;
+};
+
+// 参数格式化测试
+TEST_F(AsyncLoggerTest, FormatsArguments) {
+    AsyncLogger logger(fd());
+    logger.log("no args");
+    logger.log("int {} uint {} double {} char {} bool {} str {}",
+               -42, 7u, 1.5, 'x', true, "abc");
+    logger.log("missing {} {}", 1);
+    logger.log("px {} big {} tiny {} third {}", 1234567.89, 123456789.0, 1e-300, 1.0 / 3);
+    logger.flush();
+
+    auto lines = readLines();
+    ASSERT_EQ(lines.size(), 4u);
+    ASSERT_EQ(lines[0], "no args");
+    ASSERT_EQ(lines[1], "int -42 uint 7 double 1.5 char x bool true str abc");
+    ASSERT_EQ(lines[2], "missing 1 {}");
+    // 浮点数不截断为6位有效数字，且能原样解析回来
+    ASSERT_EQ(lines[3], "px 1234567.89 big 123456789 tiny 1e-300 third 0.3333333333333333");
+    double third = 0;
+    ASSERT_EQ(sscanf(lines[3].c_str(), "px %*s big %*s tiny %*s third %lf", &third), 1);
+    ASSERT_EQ(third, 1.0 / 3);
+}
+
+// 多线程写入：每个线程内部有序，且不丢失
+TEST_F(AsyncLoggerTest, MultiThreadPerThreadOrder) {
+    const int THREAD_COUNT = 4;
+    const int LINES_PER_THREAD = 10000;
+    {
+        AsyncLogger logger(fd(), 256);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREAD_COUNT; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < LINES_PER_THREAD; ++i) {
+                    ASSERT_TRUE(logger.log("t {} i {}", t, i));
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+        // 析构时写出剩余日志
+    }
+
+    std::vector<int> next(THREAD_COUNT, 0);
+    for (const auto& line : readLines()) {
+        int t = -1, i = -1;
+        ASSERT_EQ(sscanf(line.c_str(), "t %d i %d", &t, &i), 2);
+        ASSERT_EQ(i, next[t]);
+        next[t]++;
+    }
+    for (int count : next) {
+        ASSERT_EQ(count, LINES_PER_THREAD);
+    }
+}
+
+// 环满丢弃策略
+TEST_F(AsyncLoggerTest, DropPolicyCountsDroppedRecords) {
+    const int TOTAL = 100;
+    int accepted = 0;
+    {
+        AsyncLogger logger(fd(), 8, LogFullPolicy::Drop, std::chrono::milliseconds(200));
+        for (int i = 0; i < TOTAL; ++i) {
+            if (logger.log("record {}", i)) {
+                accepted++;
+            }
+        }
+        logger.flush();
+    }
+    ASSERT_LT(accepted, TOTAL);
+
+    int records = 0;
+    int dropped = 0;
+    for (const auto& line : readLines()) {
+        int n = 0;
+        if (sscanf(line.c_str(), "[async_logger] dropped %d records", &n) == 1) {
+            dropped += n;
+        } else {
+            records++;
+        }
+    }
+    ASSERT_EQ(records, accepted);
+    ASSERT_EQ(dropped, TOTAL - accepted);
+}
+
+// 新线程注册后立即 flush：本线程的日志一定已写出
+TEST_F(AsyncLoggerTest, RegisterThenFlushImmediately) {
+    const int THREAD_COUNT = 200;
+    AsyncLogger logger(fd(), 64, LogFullPolicy::Block, std::chrono::milliseconds(1));
+    std::atomic<int> missing{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; ++t) {
+        threads.emplace_back([&, t]() {
+            logger.log("thread {}", t);
+            logger.flush();
+            std::string expected = "thread " + std::to_string(t);
+            bool found = false;
+            for (const auto& line : readLines()) {
+                if (line == expected) {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                missing++;
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    ASSERT_EQ(missing.load(), 0);
+}
+
+// 其他线程持续写日志时 flush 也能完成
+TEST_F(AsyncLoggerTest, FlushUnderSteadyLogging) {
+    AsyncLogger logger(fd(), 1024);
+    std::atomic<bool> stop{false};
+    std::thread noisy([&]() {
+        int i = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            logger.log("noise {}", i++);
+        }
+    });
+    for (int i = 0; i < 100; ++i) {
+        logger.log("marker {}", i);
+        logger.flush();
+    }
+    stop = true;
+    noisy.join();
+}
+
+// 线程退出后它的环在写完后被释放
+TEST_F(AsyncLoggerTest, RingsReleasedAfterThreadExit) {
+    const int THREAD_COUNT = 100;
+    AsyncLogger logger(fd(), 64, LogFullPolicy::Block, std::chrono::microseconds(100));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; ++t) {
+        threads.emplace_back([&, t]() { logger.log("thread {}", t); });
+    }
+    for (auto& t : threads) t.join();
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (logger.ring_count() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(logger.ring_count(), 0u);
+    ASSERT_EQ(readLines().size(), static_cast<size_t>(THREAD_COUNT));
+}
+
+// 生产者单次调用开销
+TEST_F(AsyncLoggerTest, ProducerLatencyBenchmark) {
+    const int CALLS = 100000;
+    int null_fd = open("/dev/null", O_WRONLY);
+    ASSERT_GE(null_fd, 0);
+    {
+        // 后端空闲休眠较长，避免单核机器上后端线程抢占计时
+        AsyncLogger logger(null_fd, CALLS, LogFullPolicy::Drop, std::chrono::milliseconds(200));
+
+        // 多轮取中位数，排除单次调度抖动；每轮前先写满一次环，避免计入缺页
+        const int ROUNDS = 5;
+        std::vector<double> results;
+        for (int round = 0; round <= ROUNDS; ++round) {
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < CALLS; ++i) {
+                logger.log("order {} filled qty {} px {}", i, 100u, 101.25);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            logger.flush();
+            if (round > 0) {
+                results.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    end - start).count() / double(CALLS));
+            }
+        }
+        std::sort(results.begin(), results.end());
+        double ns_per_call = results[ROUNDS / 2];
+        std::cout << "单次日志调用: " << ns_per_call << " ns" << std::endl;
+
+        // 目标：单次调用低于50ns
+        ASSERT_LT(ns_per_call, 50);
+    }
+    close(null_fd);
+}
@@ -0,0 +1,217 @@
+#include "mpmc_queue.h"
+#include "mpsc_queue.h"
+#include <gtest/gtest.h>  // Google Test框架
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+class MPMCTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        // 确保所有线程完成
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+};
+
+// 单线程基本操作测试
+TEST_F(MPMCTest, SingleThreadFIFO) {
+    MPMCQueue<int> queue;
+    int value;
+
+    ASSERT_FALSE(queue.dequeue(value));
+    for (int i = 0; i < 1000; ++i) {
+        queue.enqueue(i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(queue.dequeue(value));
+        ASSERT_EQ(value, i);
+    }
+    ASSERT_FALSE(queue.dequeue(value));
+}
+
+// 非平凡类型：未出队元素在析构时释放
+TEST_F(MPMCTest, NonTrivialPayload) {
+    MPMCQueue<std::unique_ptr<int>> queue;
+    for (int i = 0; i < 100; ++i) {
+        queue.enqueue(std::make_unique<int>(i));
+    }
+    std::unique_ptr<int> value;
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_TRUE(queue.dequeue(value));
+        ASSERT_EQ(*value, i);
+    }
+}
+
+// 多生产者多消费者：每个元素恰好被消费一次，且每个消费者看到的同一生产者元素有序
+TEST_F(MPMCTest, MultiProducerMultiConsumerIntegrity) {
+    MPMCQueue<int> queue;
+    const int PRODUCER_COUNT = 4;
+    const int CONSUMER_COUNT = 4;
+    const int ITEMS_PER_PRODUCER = 50000;
+    const int TOTAL_ITEMS = PRODUCER_COUNT * ITEMS_PER_PRODUCER;
+
+    std::vector<std::atomic<int>> seen(TOTAL_ITEMS);
+    std::atomic<int> consumed{0};
+    std::atomic<bool> order_ok{true};
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < PRODUCER_COUNT; ++i) {
+        threads.emplace_back([&, i]() {
+            for (int j = 0; j < ITEMS_PER_PRODUCER; ++j) {
+                queue.enqueue(i * ITEMS_PER_PRODUCER + j);
+            }
+        });
+    }
+    for (int i = 0; i < CONSUMER_COUNT; ++i) {
+        threads.emplace_back([&]() {
+            std::vector<int> last(PRODUCER_COUNT, -1);
+            int value;
+            while (consumed.load(std::memory_order_relaxed) < TOTAL_ITEMS) {
+                if (queue.dequeue(value)) {
+                    seen[value].fetch_add(1, std::memory_order_relaxed);
+                    int producer = value / ITEMS_PER_PRODUCER;
+                    if (value <= last[producer]) {
+                        order_ok.store(false);
+                    }
+                    last[producer] = value;
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    ASSERT_TRUE(order_ok.load());
+    ASSERT_EQ(consumed.load(), TOTAL_ITEMS);
+    for (int i = 0; i < TOTAL_ITEMS; ++i) {
+        ASSERT_EQ(seen[i].load(), 1);
+    }
+}
+
+// 多个消费者同时出队（由 MPSCQueue 测试迁移，MPSCQueue 只允许单消费者）
+TEST_F(MPMCTest, ConcurrentConsumers) {
+    MPMCQueue<int> queue;
+    const int CONSUMER_THREADS = 3;
+    const int TOTAL_ITEMS = 1500;
+
+    std::vector<std::thread> consumers;
+    std::atomic<int> consumed{0};
+    std::vector<int> consumed_counts(CONSUMER_THREADS, 0);
+
+    // 先填充一些数据
+    for (int i = 0; i < 1000; ++i) {
+        queue.enqueue(i);
+    }
+
+    for (int i = 0; i < CONSUMER_THREADS; ++i) {
+        consumers.emplace_back([&, i]() {
+            int value;
+            while (consumed.load(std::memory_order_relaxed) < TOTAL_ITEMS) {
+                if (queue.dequeue(value)) {
+                    consumed_counts[i]++;
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    // 继续生产
+    for (int i = 1000; i < TOTAL_ITEMS; ++i) {
+        queue.enqueue(i);
+    }
+
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+
+    int total_consumed = 0;
+    for (int count : consumed_counts) {
+        total_consumed += count;
+    }
+    ASSERT_EQ(total_consumed, TOTAL_ITEMS);
+    int value;
+    ASSERT_FALSE(queue.dequeue(value));
+}
+
+// 内存回收测试：短生命周期线程反复出入队，风险指针记录被复用
+TEST_F(MPMCTest, MemoryReclamationWithThreadChurn) {
+    MPMCQueue<int> queue;
+    for (int round = 0; round < 50; ++round) {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i) {
+            threads.emplace_back([&]() {
+                int value;
+                for (int j = 0; j < 1000; ++j) {
+                    queue.enqueue(j);
+                    queue.dequeue(value);
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+    }
+    int value;
+    while (queue.dequeue(value)) {}
+}
+
+// 对比基准：有界/无界 MPSCQueue 与 MPMCQueue
+TEST_F(MPMCTest, ThroughputComparison) {
+    const int PRODUCER_COUNT = 4;
+    const int ITEMS_PER_PRODUCER = 100000;
+    const int TOTAL_ITEMS = PRODUCER_COUNT * ITEMS_PER_PRODUCER;
+
+    // 运行 PRODUCER_COUNT 个生产者和 consumer_count 个消费者，返回每秒操作数
+    auto run = [&](int consumer_count,
+                   const std::function<void(int)>& enqueue,
+                   const std::function<bool(int&, int)>& dequeue) {
+        std::atomic<int> consumed{0};
+        auto start_time = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < PRODUCER_COUNT; ++i) {
+            threads.emplace_back([&, i]() {
+                for (int j = 0; j < ITEMS_PER_PRODUCER; ++j) {
+                    enqueue(i * ITEMS_PER_PRODUCER + j);
+                }
+            });
+        }
+        for (int i = 0; i < consumer_count; ++i) {
+            threads.emplace_back([&, i]() {
+                int value;
+                while (consumed.load(std::memory_order_relaxed) < TOTAL_ITEMS) {
+                    if (dequeue(value, i)) {
+                        consumed.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        return TOTAL_ITEMS * 1e6 / (duration.count() + 1);
+    };
+
+    {
+        MPSCQueue<int> queue;
+        double ops = run(1, [&](int v) { queue.enqueue(v); },
+                         [&](int& v, int id) { return queue.dequeue(v, id); });
+        std::cout << "MPSC 无界 4P/1C: " << ops << " 操作/秒" << std::endl;
+        ASSERT_GT(ops, 100000);
+    }
+    {
+        MPSCQueue<int> queue(4096, OverflowPolicy::Block);
+        double ops = run(1, [&](int v) { queue.enqueue(v); },
+                         [&](int& v, int id) { return queue.dequeue(v, id); });
+        std::cout << "MPSC 有界 4P/1C: " << ops << " 操作/秒" << std::endl;
+        ASSERT_GT(ops, 100000);
+    }
+    for (int consumers : {1, 4}) {
+        MPMCQueue<int> queue;
+        double ops = run(consumers, [&](int v) { queue.enqueue(v); },
+                         [&](int& v, int) { return queue.dequeue(v); });
+        std::cout << "MPMC 无界 4P/" << consumers << "C: " << ops << " 操作/秒" << std::endl;
+        // 性能断言（根据硬件调整阈值）
+        ASSERT_GT(ops, 100000);
+    }
+}
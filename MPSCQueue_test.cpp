@@ -247,52 +247,6 @@ TEST_F(MPSCTest, MemoryReclamation) {
     }
 }
 
-// 并发消费者ID测试
-TEST_F(MPSCTest, ConcurrentConsumerIds) {
-    MPSCQueue<int> queue;
-    const int CONSUMER_THREADS = 3; // 测试多个消费者ID
-    
-    std::vector<std::thread> consumers;
-    std::atomic<int> stop_consumers{false};
-    std::vector<int> consumed_counts(CONSUMER_THREADS, 0);
-    
-    // 先填充一些数据
-    for (int i = 0; i < 1000; ++i) {
-        queue.enqueue(i);
-    }
-    
-    // 启动多个消费者（使用不同ID）
-    for (int i = 0; i < CONSUMER_THREADS; ++i) {
-        consumers.emplace_back([&, i]() {
-            int value;
-            while (!stop_consumers.load()) {
-                if (queue.dequeue(value, i)) { // 使用不同的消费者ID
-                    consumed_counts[i]++;
-                }
-            }
-        });
-    }
-    
-    // 继续生产
-    for (int i = 0; i < 500; ++i) {
-        queue.enqueue(i);
-    }
-    
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    stop_consumers.store(true);
-    
-    for (auto& consumer : consumers) {
-        consumer.join();
-    }
-    
-    // 验证所有消费者都能正常工作
-    int total_consumed = 0;
-    for (int count : consumed_counts) {
-        total_consumed += count;
-        ASSERT_GE(count, 0);
-    }
-}
-
 // 内存泄漏检测
 TEST_F(MPSCTest, MemoryLeakCheck) {
     // 在Valgrind或AddressSanitizer下运行
@@ -353,3 +307,122 @@ TEST_F(MPSCTest, ThreadSafetyStressTest) {
     // 如果没有数据竞争，ThreadSanitizer不会报告错误
     SUCCEED();
 }
+
+// 有界队列：try_enqueue 在队满时失败
+TEST_F(MPSCTest, BoundedTryEnqueue) {
+    MPSCQueue<int> queue(100);
+    int value;
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(queue.try_enqueue(i));
+    }
+    ASSERT_FALSE(queue.try_enqueue(100));
+    ASSERT_EQ(queue.size_approx(), 100u);
+
+    ASSERT_TRUE(queue.dequeue(value, 0));
+    ASSERT_EQ(value, 0);
+    ASSERT_TRUE(queue.try_enqueue(100));
+    ASSERT_FALSE(queue.try_enqueue(101));
+
+    for (int i = 1; i <= 100; ++i) {
+        ASSERT_TRUE(queue.dequeue(value, 0));
+        ASSERT_EQ(value, i);
+    }
+    ASSERT_FALSE(queue.dequeue(value, 0));
+    ASSERT_EQ(queue.size_approx(), 0u);
+}
+
+// 有界队列：慢消费者下阻塞式 enqueue 限制内存
+TEST_F(MPSCTest, BoundedBlockingBackpressure) {
+    const size_t CAPACITY = 64;
+    const int PRODUCER_COUNT = 4;
+    const int ITEMS_PER_PRODUCER = 1000;
+    const int TOTAL_ITEMS = PRODUCER_COUNT * ITEMS_PER_PRODUCER;
+    MPSCQueue<int> queue(CAPACITY, OverflowPolicy::Block);
+
+    std::vector<std::thread> producers;
+    for (int i = 0; i < PRODUCER_COUNT; ++i) {
+        producers.emplace_back([&, i]() {
+            for (int j = 0; j < ITEMS_PER_PRODUCER; ++j) {
+                ASSERT_TRUE(queue.enqueue(i * ITEMS_PER_PRODUCER + j));
+            }
+        });
+    }
+
+    // 慢速消费者，同时检查队列长度不超过容量+生产者数
+    std::set<int> received_values;
+    size_t max_size = 0;
+    int value;
+    while (received_values.size() < static_cast<size_t>(TOTAL_ITEMS)) {
+        max_size = std::max(max_size, queue.size_approx());
+        if (queue.dequeue(value, 0)) {
+            ASSERT_TRUE(received_values.insert(value).second);
+            if (value % 100 == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(10));
+            }
+        }
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    ASSERT_LE(max_size, CAPACITY + PRODUCER_COUNT);
+    ASSERT_EQ(queue.dropped(), 0u);
+}
+
+// 有界队列：DropNewest 丢弃新元素
+TEST_F(MPSCTest, BoundedDropNewest) {
+    MPSCQueue<int> queue(10, OverflowPolicy::DropNewest);
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_EQ(queue.enqueue(i), i < 10);
+    }
+    ASSERT_EQ(queue.dropped(), 10u);
+
+    int value;
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(queue.dequeue(value, 0));
+        ASSERT_EQ(value, i);
+    }
+    ASSERT_FALSE(queue.dequeue(value, 0));
+}
+
+// 有界队列：DropOldest 保留最新元素
+TEST_F(MPSCTest, BoundedDropOldest) {
+    MPSCQueue<int> queue(10, OverflowPolicy::DropOldest);
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_TRUE(queue.enqueue(i));
+    }
+    ASSERT_EQ(queue.size_approx(), 10u);
+
+    // 达到2倍容量后退化为丢弃新元素，内存仍有上界
+    ASSERT_FALSE(queue.enqueue(20));
+    ASSERT_EQ(queue.dropped(), 1u);
+
+    // 旧元素在出队时被跳过
+    int value;
+    for (int i = 10; i < 20; ++i) {
+        ASSERT_TRUE(queue.dequeue(value, 0));
+        ASSERT_EQ(value, i);
+    }
+    ASSERT_FALSE(queue.dequeue(value, 0));
+    ASSERT_EQ(queue.dropped(), 11u);
+    ASSERT_EQ(queue.size_approx(), 0u);
+}
+
+// DropOldest：消费者取空后，容量以内的新元素不会被误丢
+TEST_F(MPSCTest, BoundedDropOldestNoSpuriousDrop) {
+    MPSCQueue<int> queue(4, OverflowPolicy::DropOldest);
+    int value;
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_TRUE(queue.enqueue(round * 4 + i));
+        }
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_TRUE(queue.dequeue(value, 0));
+            ASSERT_EQ(value, round * 4 + i);
+        }
+        ASSERT_FALSE(queue.dequeue(value, 0));
+    }
+    ASSERT_EQ(queue.dropped(), 0u);
+}
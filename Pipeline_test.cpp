@@ -0,0 +1,225 @@
+#include "pipeline.h"
+#include <gtest/gtest.h>  // Google Test框架
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <string>
+
+class PipelineTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        // 确保所有线程完成
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+};
+
+// SPSCQueue 批量接口测试
+TEST_F(PipelineTest, SpscBulkOperations) {
+    SPSCQueue<int> queue(10);
+    int in[16];
+    int out[16];
+    for (int i = 0; i < 16; ++i) in[i] = i;
+
+    ASSERT_EQ(queue.enqueue_bulk(in, 16), 10u); // 只能放下容量个
+    ASSERT_EQ(queue.size(), 10u);
+    ASSERT_EQ(queue.enqueue_bulk(in, 1), 0u);
+
+    ASSERT_EQ(queue.dequeue_bulk(out, 4), 4u);
+    ASSERT_EQ(queue.enqueue_bulk(in + 10, 6), 4u); // 跨越数组末尾回绕
+    ASSERT_EQ(queue.dequeue_bulk(out + 4, 16), 10u);
+    for (int i = 0; i < 14; ++i) {
+        ASSERT_EQ(out[i], i);
+    }
+    ASSERT_EQ(queue.size(), 0u);
+    ASSERT_EQ(queue.dequeue_bulk(out, 16), 0u);
+}
+
+// 三阶段流水线：顺序保持，流结束正常传播
+TEST_F(PipelineTest, SourceTransformSink) {
+    const int COUNT = 100000;
+    int next = 0;
+    std::vector<long long> received;
+    received.reserve(COUNT);
+
+    auto pipeline = Pipeline::source<int>([&](int& out) {
+            if (next == COUNT) return false;
+            out = next++;
+            return true;
+        }, {"source"})
+        .then([](int& x) { return static_cast<long long>(x) * 2; }, {"double"})
+        .then([](long long& x) { return std::to_string(x); }, {"format", -1, 32, 128})
+        .sink([&](std::string& s) { received.push_back(std::stoll(s)); }, {"sink"});
+    pipeline.run();
+
+    ASSERT_EQ(received.size(), static_cast<size_t>(COUNT));
+    for (int i = 0; i < COUNT; ++i) {
+        ASSERT_EQ(received[i], 2LL * i);
+    }
+
+    auto stats = pipeline.stats();
+    ASSERT_EQ(stats.size(), 4u);
+    for (const auto& st : stats) {
+        ASSERT_EQ(st.items, static_cast<uint64_t>(COUNT));
+        ASSERT_EQ(st.queue_depth, 0u);
+        ASSERT_GT(st.seconds, 0);
+    }
+    ASSERT_EQ(stats[2].name, "format");
+}
+
+// 空流：源直接结束，所有阶段退出
+TEST_F(PipelineTest, EmptyStream) {
+    int sunk = 0;
+    auto pipeline = Pipeline::source<int>([](int&) { return false; })
+        .then([](int& x) { return x + 1; })
+        .sink([&](int&) { sunk++; });
+    pipeline.run();
+
+    ASSERT_EQ(sunk, 0);
+    for (const auto& st : pipeline.stats()) {
+        ASSERT_EQ(st.items, 0u);
+    }
+}
+
+// batch_size/queue_capacity 为0时按1处理，不会死循环或死锁
+TEST_F(PipelineTest, ZeroOptionsClamped) {
+    const int COUNT = 1000;
+    int next = 0;
+    long long sum = 0;
+    auto pipeline = Pipeline::source<int>([&](int& out) {
+            if (next == COUNT) return false;
+            out = next++;
+            return true;
+        }, {"source", -1, 0, 0})
+        .then([](int& x) { return x + 1; }, {"inc", -1, 0, 0})
+        .sink([&](int& x) { sum += x; }, {"sink", -1, 0, 0});
+    pipeline.run();
+    ASSERT_EQ(sum, static_cast<long long>(COUNT) * (COUNT + 1) / 2);
+}
+
+// 源暂时无数据：不满一批的元素立即交给下游，而不是等到凑满或流结束
+TEST_F(PipelineTest, IdleSourceFlushesPartialBatch) {
+    std::atomic<int> produced{0};
+    std::atomic<int> sunk{0};
+    std::atomic<bool> finish{false};
+    int pending = 0;
+
+    auto pipeline = Pipeline::source<int>([&](int& out) {
+            if (pending > 0) {
+                --pending;
+                out = produced++;
+                return SourceStatus::Ready;
+            }
+            if (finish.load()) return SourceStatus::End;
+            if (produced.load() == 0) {
+                pending = 3; // 只产出3个，远小于一批
+            }
+            return SourceStatus::Idle;
+        }, {"source", -1, 64})
+        .sink([&](int&) { sunk++; }, {"sink", -1, 64});
+    pipeline.start();
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (sunk.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    int sunk_before_end = sunk.load(); // 流还没有结束
+    finish = true;
+    pipeline.wait();
+    ASSERT_EQ(sunk_before_end, 3);
+
+    auto stats = pipeline.stats();
+    ASSERT_EQ(stats[0].items, 3u);
+    ASSERT_GT(stats[0].input_waits, 0u);
+}
+
+// CPU绑定在阶段线程内完成，不存在的CPU报告为未绑定
+TEST_F(PipelineTest, PinningReported) {
+    // 选一个本进程允许使用的CPU
+    cpu_set_t allowed;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    int cpu = 0;
+    while (!CPU_ISSET(cpu, &allowed)) {
+        ++cpu;
+    }
+
+    int next = 0;
+    int sunk = 0;
+    auto pipeline = Pipeline::source<int>([&](int& out) {
+            if (next == 100) return false;
+            out = next++;
+            return true;
+        }, {"pinned", cpu})
+        .then([](int& x) { return x; }, {"unpinned"})
+        .sink([&](int&) { sunk++; }, {"bad_cpu", 100000});
+    pipeline.run();
+
+    ASSERT_EQ(sunk, 100);
+    auto stats = pipeline.stats();
+    ASSERT_TRUE(stats[0].pinned);
+    ASSERT_FALSE(stats[1].pinned);
+    ASSERT_FALSE(stats[2].pinned);
+}
+
+// 慢阶段定位：慢sink导致上游输出队列堆积并等待
+TEST_F(PipelineTest, StatsIdentifyBottleneck) {
+    const int COUNT = 2000;
+    int next = 0;
+    std::atomic<int> sunk{0};
+
+    auto pipeline = Pipeline::source<int>([&](int& out) {
+            if (next == COUNT) return false;
+            out = next++;
+            return true;
+        }, {"fast", -1, 16, 64})
+        .sink([&](int&) {
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+            sunk++;
+        }, {"slow", 0, 16});
+    pipeline.start();
+
+    // 运行中也可以读取统计
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    auto running = pipeline.stats();
+    ASSERT_EQ(running.size(), 2u);
+
+    pipeline.wait();
+    ASSERT_EQ(sunk.load(), COUNT);
+
+    auto stats = pipeline.stats();
+    ASSERT_GT(stats[0].output_waits, 0u); // 源被下游阻塞
+    std::cout << stats[0].name << " 吞吐量: " << stats[0].throughput() << " 个/秒, "
+              << stats[1].name << " 吞吐量: " << stats[1].throughput() << " 个/秒" << std::endl;
+}
+
+// 吞吐量测试
+TEST_F(PipelineTest, ThroughputBenchmark) {
+    const int COUNT = 5000000;
+    int next = 0;
+    long long sum = 0;
+
+    auto pipeline = Pipeline::source<int>([&](int& out) {
+            if (next == COUNT) return false;
+            out = next++;
+            return true;
+        }, {"source", -1, 256, 4096})
+        .then([](int& x) { return x + 1; }, {"inc", -1, 256, 4096})
+        .sink([&](int& x) { sum += x; }, {"sink", -1, 256});
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    pipeline.run();
+    auto end_time = std::chrono::high_resolution_clock::now();
+
+    ASSERT_EQ(sum, static_cast<long long>(COUNT) * (COUNT + 1) / 2);
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    double ops_per_sec = (COUNT * 1000.0) / (duration.count() + 1);
+    std::cout << "吞吐量: " << ops_per_sec << " 个/秒" << std::endl;
+    for (const auto& st : pipeline.stats()) {
+        std::cout << "  " << st.name << ": 输入等待 " << st.input_waits
+                  << ", 输出等待 " << st.output_waits << std::endl;
+    }
+
+    // 性能断言（根据硬件调整阈值）
+    ASSERT_GT(ops_per_sec, 100000);
+}
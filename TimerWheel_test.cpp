@@ -0,0 +1,209 @@
+#include "timer_wheel.h"
+#include <gtest/gtest.h>  // Google Test框架
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <set>
+
+class TimerWheelTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        // 确保所有线程完成
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+};
+
+// 单线程基本到期测试
+TEST_F(TimerWheelTest, BasicExpiry) {
+    TimerWheel<int> wheel;
+    std::vector<int> fired;
+    auto on_expire = [&](uint64_t, int& payload) { fired.push_back(payload); };
+
+    wheel.schedule_at(10, 1);
+    wheel.schedule_at(5, 2);
+
+    ASSERT_EQ(wheel.advance(4, on_expire), 0u);
+    ASSERT_EQ(wheel.size(), 2u);
+
+    ASSERT_EQ(wheel.advance(5, on_expire), 1u);
+    ASSERT_EQ(fired, std::vector<int>({2}));
+
+    ASSERT_EQ(wheel.advance(20, on_expire), 1u);
+    ASSERT_EQ(fired, std::vector<int>({2, 1}));
+    ASSERT_EQ(wheel.size(), 0u);
+}
+
+// 已过期的定时器在下一次推进时立即触发
+TEST_F(TimerWheelTest, PastDeadlineFiresImmediately) {
+    TimerWheel<int> wheel(1000);
+    int count = 0;
+    auto on_expire = [&](uint64_t, int&) { count++; };
+
+    wheel.schedule_at(10, 0);
+    ASSERT_EQ(wheel.advance(1000, on_expire), 1u);
+    ASSERT_EQ(count, 1);
+}
+
+// 跨层级联：长延迟定时器必须在准确的tick到期
+TEST_F(TimerWheelTest, CascadeFiresAtExactTick) {
+    TimerWheel<uint64_t> wheel(7);
+    const std::vector<uint64_t> deadlines = {
+        7, 255, 256, 300, 16383, 16384, 70000, 1u << 20, (1u << 26) + 3, 5000000000ull
+    };
+    for (uint64_t d : deadlines) {
+        wheel.schedule_at(d, d);
+    }
+
+    std::vector<uint64_t> fired;
+    uint64_t tick = 7;
+    auto on_expire = [&](uint64_t, uint64_t& payload) {
+        ASSERT_EQ(payload, tick);
+        fired.push_back(payload);
+    };
+
+    // 逐个跳到每个到期点的前一个tick和到期tick
+    for (uint64_t d : deadlines) {
+        if (d > tick) {
+            tick = d - 1;
+            ASSERT_EQ(wheel.advance(tick, on_expire), 0u);
+        }
+        tick = d;
+        ASSERT_EQ(wheel.advance(tick, on_expire), 1u);
+    }
+    ASSERT_EQ(fired, deadlines);
+}
+
+// 取消测试
+TEST_F(TimerWheelTest, Cancel) {
+    TimerWheel<int> wheel;
+    std::set<int> fired;
+    auto on_expire = [&](uint64_t, int& payload) { fired.insert(payload); };
+
+    std::vector<uint64_t> ids;
+    for (int i = 0; i < 1000; ++i) {
+        ids.push_back(wheel.schedule_after(i % 500 + 1, i));
+    }
+    wheel.poll();
+    ASSERT_EQ(wheel.size(), 1000u);
+
+    // 取消偶数定时器
+    for (int i = 0; i < 1000; i += 2) {
+        wheel.cancel(ids[i]);
+    }
+    wheel.advance(1000, on_expire);
+
+    ASSERT_EQ(fired.size(), 500u);
+    for (int v : fired) {
+        ASSERT_EQ(v % 2, 1);
+    }
+
+    // 取消已到期的定时器是空操作
+    wheel.cancel(ids[1]);
+    wheel.poll();
+    ASSERT_EQ(wheel.size(), 0u);
+}
+
+// 节点复用后，旧ID不会取消占用同一节点的新定时器
+TEST_F(TimerWheelTest, StaleIdAfterSlotReuse) {
+    TimerWheel<int> wheel;
+    std::vector<int> fired;
+    auto on_expire = [&](uint64_t, int& payload) { fired.push_back(payload); };
+
+    uint64_t old_id = wheel.schedule_at(1, 1);
+    ASSERT_EQ(wheel.advance(1, on_expire), 1u);
+
+    uint64_t new_id = wheel.schedule_at(5, 2);
+    ASSERT_NE(new_id, old_id);
+    wheel.cancel(old_id);
+    ASSERT_EQ(wheel.advance(10, on_expire), 1u);
+    ASSERT_EQ(fired, std::vector<int>({1, 2}));
+}
+
+// 多生产者提交，拥有者线程推进
+TEST_F(TimerWheelTest, MultiProducerSchedule) {
+    TimerWheel<int> wheel;
+    const int PRODUCER_COUNT = 4;
+    const int TIMERS_PER_PRODUCER = 10000;
+    const int TOTAL = PRODUCER_COUNT * TIMERS_PER_PRODUCER;
+    const uint64_t MAX_TICK = 2000; // 生产期间拥有者最多推进到的tick
+
+    std::vector<std::thread> producers;
+    for (int i = 0; i < PRODUCER_COUNT; ++i) {
+        producers.emplace_back([&, i]() {
+            for (int j = 0; j < TIMERS_PER_PRODUCER; ++j) {
+                const int payload = i * TIMERS_PER_PRODUCER + j;
+                if (j % 4 == 0) {
+                    // 取消的定时器到期时间晚于生产期间能推进到的tick，避免取消前已经到期
+                    uint64_t id = wheel.schedule_after(MAX_TICK + j % 1000 + 1, payload);
+                    wheel.cancel(id); // 同线程取消，顺序有保证
+                } else {
+                    wheel.schedule_after(j % 1000 + 1, payload);
+                }
+            }
+        });
+    }
+
+    std::set<int> fired;
+    auto on_expire = [&](uint64_t, int& payload) {
+        ASSERT_TRUE(fired.insert(payload).second);
+    };
+
+    uint64_t tick = 0;
+    std::atomic<bool> done{false};
+    std::thread joiner([&]() {
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        done.store(true);
+    });
+
+    while (!done.load()) {
+        if (tick < MAX_TICK) {
+            ++tick;
+        }
+        wheel.advance(tick, on_expire);
+    }
+    joiner.join();
+    wheel.advance(tick + MAX_TICK + 2000, on_expire);
+
+    ASSERT_EQ(fired.size(), static_cast<size_t>(TOTAL - TOTAL / 4));
+    ASSERT_EQ(wheel.size(), 0u);
+}
+
+// 1000万未到期定时器的插入、取消与到期基准
+TEST_F(TimerWheelTest, TenMillionTimersBenchmark) {
+    TimerWheel<uint32_t> wheel;
+    const uint32_t TIMERS = 10000000;
+    const uint64_t SPAN = 1u << 20;
+    wheel.reserve(TIMERS);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<uint64_t> ids;
+    ids.reserve(TIMERS);
+    for (uint32_t i = 0; i < TIMERS; ++i) {
+        // 到期时间分布在多个层级上
+        ids.push_back(wheel.schedule_at((i * 2654435761u) % SPAN + 1, i));
+    }
+    wheel.poll();
+    auto inserted = std::chrono::high_resolution_clock::now();
+    ASSERT_EQ(wheel.size(), TIMERS);
+
+    for (uint32_t i = 0; i < TIMERS; i += 2) {
+        wheel.cancel(ids[i]);
+    }
+    wheel.poll();
+    auto cancelled = std::chrono::high_resolution_clock::now();
+    ASSERT_EQ(wheel.size(), TIMERS / 2);
+
+    size_t fired = wheel.advance(SPAN, [](uint64_t, uint32_t&) {});
+    auto end = std::chrono::high_resolution_clock::now();
+    ASSERT_EQ(fired, TIMERS / 2);
+
+    auto ns_per = [](auto d, size_t n) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() / double(n);
+    };
+    std::cout << "插入: " << ns_per(inserted - start, TIMERS) << " ns/个" << std::endl;
+    std::cout << "取消: " << ns_per(cancelled - inserted, TIMERS / 2) << " ns/个" << std::endl;
+    std::cout << "到期: " << ns_per(end - cancelled, TIMERS / 2) << " ns/个" << std::endl;
+}
@@ -0,0 +1,406 @@
+#ifndef __ASYNC_LOGGER__
+#define __ASYNC_LOGGER__
+
+#include <sys/uio.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "spsc_queue.h"
+
+// 单条日志最多携带的参数个数
+static constexpr size_t LOG_MAX_ARGS = 6;
+
+// 参数类型标签，后端据此格式化
+enum class LogArgType : uint8_t { Int, UInt, Double, Char, Bool, CStr };
+
+struct LogArg {
+    LogArgType type;
+    union {
+        int64_t i;
+        uint64_t u;
+        double d;
+        const char* s;
+    };
+};
+
+// 二进制日志记录：格式串指针即格式ID，参数按原始值保存，格式化推迟到后端线程
+struct LogRecord {
+    const char* fmt;
+    uint8_t nargs;
+    LogArg args[LOG_MAX_ARGS];
+};
+
+// 参数编码：只接受标量和静态生命周期的C字符串（后端读取时字符串必须仍然有效）
+inline LogArg makeLogArg(bool v) { LogArg a; a.type = LogArgType::Bool; a.u = v; return a; }
+inline LogArg makeLogArg(char v) { LogArg a; a.type = LogArgType::Char; a.i = v; return a; }
+inline LogArg makeLogArg(const char* v) { LogArg a; a.type = LogArgType::CStr; a.s = v; return a; }
+
+template<typename V, typename std::enable_if<std::is_integral<V>::value && std::is_signed<V>::value, int>::type = 0>
+inline LogArg makeLogArg(V v) { LogArg a; a.type = LogArgType::Int; a.i = v; return a; }
+
+template<typename V, typename std::enable_if<std::is_integral<V>::value && std::is_unsigned<V>::value, int>::type = 0>
+inline LogArg makeLogArg(V v) { LogArg a; a.type = LogArgType::UInt; a.u = v; return a; }
+
+template<typename V, typename std::enable_if<std::is_floating_point<V>::value, int>::type = 0>
+inline LogArg makeLogArg(V v) { LogArg a; a.type = LogArgType::Double; a.d = v; return a; }
+
+// 环满时的处理策略
+enum class LogFullPolicy {
+    Block, // 生产者让出CPU直到后端腾出空间
+    Drop,  // 丢弃本条日志并计数，后端输出丢弃提示
+};
+
+// 异步日志
+// - 每个线程第一次写日志时注册自己的 SPSCQueue 环，之后写日志只有一次无锁入队
+// - 单个后端线程轮询所有环，格式化记录（"{}" 为参数占位符）并用 writev 批量写出
+// - 线程退出时关闭自己的环，后端写完剩余记录后释放
+class AsyncLogger {
+private:
+    struct LogRing {
+        explicit LogRing(size_t capacity) : queue(capacity) {}
+
+        SPSCQueue<LogRecord> queue;
+        alignas(64) std::atomic<uint64_t> dropped{0}; // 只由生产者写
+        std::atomic<uint64_t> logged{0};              // 已入队记录数，只由生产者写
+        std::atomic<bool> closed{false};              // 生产者线程已退出
+        std::atomic<bool> logger_gone{false};         // 日志实例已析构，线程本地缓存可丢弃
+
+        // 以下只由后端访问
+        alignas(64) uint64_t reported_dropped = 0;
+        uint64_t written = 0;                         // 已写出记录数
+        uint64_t flush_target = 0;                    // 当前 flush 需要写到的记录数
+        uint64_t pass_count = 0;                      // 本轮取出、尚未写出的记录数
+        bool pass_closed = false;                     // 本轮开始时已关闭
+        std::string pending;                          // 格式化缓冲
+    };
+
+    // 线程本地的环缓存，按日志实例ID区分；线程退出时关闭所有环
+    struct RingCache {
+        struct Entry {
+            uint64_t logger_id;
+            std::shared_ptr<LogRing> ring;
+        };
+        std::vector<Entry> entries;
+
+        ~RingCache() {
+            for (auto& e : entries) {
+                e.ring->closed.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    static constexpr size_t IOV_BATCH = 64;
+
+    const int fd_;
+    const size_t ring_capacity_;
+    const LogFullPolicy policy_;
+    const std::chrono::microseconds idle_sleep_;
+    const size_t drain_batch_;
+    const uint64_t logger_id_;
+
+    std::mutex rings_mutex_; // 只在注册和释放环时使用
+    std::vector<std::shared_ptr<LogRing>> rings_;
+    alignas(64) std::atomic<uint64_t> rings_version_{0};
+
+    alignas(64) std::atomic<bool> stop_{false};
+    alignas(64) std::atomic<uint64_t> flush_requested_{0};
+    alignas(64) std::atomic<uint64_t> flush_done_{0};
+    std::thread backend_;
+
+    static uint64_t nextLoggerId() {
+        static std::atomic<uint64_t> next_id{1};
+        return next_id.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 当前线程在本日志实例上的环
+    LogRing* localRing() {
+        static thread_local RingCache cache;
+        for (const auto& e : cache.entries) {
+            if (e.logger_id == logger_id_) {
+                return e.ring.get();
+            }
+        }
+        // 顺便丢弃已析构日志实例的环
+        auto& entries = cache.entries;
+        for (size_t i = 0; i < entries.size();) {
+            if (entries[i].ring->logger_gone.load(std::memory_order_acquire)) {
+                entries[i] = std::move(entries.back());
+                entries.pop_back();
+            } else {
+                ++i;
+            }
+        }
+        auto ring = std::make_shared<LogRing>(ring_capacity_);
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex_);
+            rings_.push_back(ring);
+        }
+        rings_version_.fetch_add(1, std::memory_order_release);
+        entries.push_back({logger_id_, ring});
+        return ring.get();
+    }
+
+    static void appendArg(std::string& out, const LogArg& arg) {
+        char buf[32];
+        int n = 0;
+        switch (arg.type) {
+        case LogArgType::Int:
+            n = snprintf(buf, sizeof(buf), "%" PRId64, arg.i);
+            break;
+        case LogArgType::UInt:
+            n = snprintf(buf, sizeof(buf), "%" PRIu64, arg.u);
+            break;
+        case LogArgType::Double:
+            // 最短往返表示：输出文本能还原为同一个 double，不截断有效数字
+            n = static_cast<int>(std::to_chars(buf, buf + sizeof(buf), arg.d).ptr - buf);
+            break;
+        case LogArgType::Char:
+            out.push_back(static_cast<char>(arg.i));
+            return;
+        case LogArgType::Bool:
+            out.append(arg.u ? "true" : "false");
+            return;
+        case LogArgType::CStr:
+            out.append(arg.s ? arg.s : "(null)");
+            return;
+        }
+        out.append(buf, n);
+    }
+
+    // "{}" 依次替换为参数，多余的占位符原样输出
+    static void format(std::string& out, const LogRecord& record) {
+        size_t next_arg = 0;
+        for (const char* p = record.fmt; *p; ++p) {
+            if (p[0] == '{' && p[1] == '}' && next_arg < record.nargs) {
+                appendArg(out, record.args[next_arg++]);
+                ++p;
+            } else {
+                out.push_back(*p);
+            }
+        }
+        out.push_back('\n');
+    }
+
+    // 写出全部 iovec，处理部分写
+    void writeAll(struct iovec* iov, int count) {
+        while (count > 0) {
+            ssize_t written = ::writev(fd_, iov, count);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return; // 输出不可写时放弃本批，不影响生产者
+            }
+            while (count > 0 && static_cast<size_t>(written) >= iov->iov_len) {
+                written -= iov->iov_len;
+                ++iov;
+                --count;
+            }
+            if (count > 0) {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+                iov->iov_len -= written;
+            }
+        }
+    }
+
+    // 后端：取空所有环一轮，返回处理的记录数；已关闭且写完的环从列表中移除并释放
+    size_t drainOnce(std::vector<std::shared_ptr<LogRing>>& rings) {
+        size_t drained = 0;
+        struct iovec iov[IOV_BATCH];
+        int iov_count = 0;
+        LogRecord record;
+
+        for (size_t r = 0; r < rings.size(); ++r) {
+            LogRing* ring = rings[r].get();
+            ring->pending.clear();
+            // 先读关闭标记：关闭前写入的记录在本轮一定能取到
+            ring->pass_closed = ring->closed.load(std::memory_order_acquire);
+            ring->pass_count = 0;
+            uint64_t dropped = ring->dropped.load(std::memory_order_relaxed);
+            if (dropped != ring->reported_dropped) {
+                char buf[64];
+                int n = snprintf(buf, sizeof(buf), "[async_logger] dropped %" PRIu64 " records\n",
+                                 dropped - ring->reported_dropped);
+                ring->pending.append(buf, n);
+                ring->reported_dropped = dropped;
+            }
+            for (size_t i = 0; i < drain_batch_ && ring->queue.dequeue(record); ++i) {
+                format(ring->pending, record);
+                ++ring->pass_count;
+            }
+            drained += ring->pass_count;
+            if (ring->pending.empty()) {
+                continue;
+            }
+            if (iov_count == static_cast<int>(IOV_BATCH)) {
+                writeAll(iov, iov_count);
+                iov_count = 0;
+            }
+            iov[iov_count].iov_base = &ring->pending[0];
+            iov[iov_count].iov_len = ring->pending.size();
+            ++iov_count;
+        }
+        writeAll(iov, iov_count);
+
+        bool removed = false;
+        for (size_t r = rings.size(); r-- > 0;) {
+            LogRing* ring = rings[r].get();
+            ring->written += ring->pass_count;
+            if (ring->pass_closed && ring->queue.size() == 0) {
+                std::lock_guard<std::mutex> lock(rings_mutex_);
+                for (auto it = rings_.begin(); it != rings_.end(); ++it) {
+                    if (*it == rings[r]) {
+                        rings_.erase(it);
+                        break;
+                    }
+                }
+                rings.erase(rings.begin() + r);
+                removed = true;
+            }
+        }
+        if (removed) {
+            rings_version_.fetch_add(1, std::memory_order_release);
+        }
+        return drained;
+    }
+
+    void refreshRings(std::vector<std::shared_ptr<LogRing>>& rings, uint64_t& version) {
+        uint64_t current = rings_version_.load(std::memory_order_acquire);
+        if (current != version) {
+            std::lock_guard<std::mutex> lock(rings_mutex_);
+            rings = rings_;
+            version = current;
+        }
+    }
+
+    void backendLoop() {
+        std::vector<std::shared_ptr<LogRing>> rings;
+        uint64_t version = ~0ull;
+        uint64_t active_flush = 0; // 正在等待完成的 flush 序号，0表示没有
+        uint64_t done = 0;
+        while (true) {
+            // 先读 stop/flush 再刷新环列表，保证请求之前注册的环都在本轮中
+            const bool stopping = stop_.load(std::memory_order_acquire);
+            const uint64_t flush_seq = flush_requested_.load(std::memory_order_acquire);
+            refreshRings(rings, version);
+
+            if (active_flush == 0 && flush_seq > done) {
+                // 记下每个环此刻的入队位置，写到这里即完成，不需要等到空闲
+                for (auto& ring : rings) {
+                    ring->flush_target = ring->logged.load(std::memory_order_acquire);
+                }
+                active_flush = flush_seq;
+            }
+
+            const size_t drained = drainOnce(rings);
+
+            if (active_flush != 0) {
+                bool reached = true;
+                for (auto& ring : rings) {
+                    if (ring->written < ring->flush_target) {
+                        reached = false;
+                        break;
+                    }
+                }
+                if (reached) {
+                    done = active_flush;
+                    flush_done_.store(done, std::memory_order_release);
+                    active_flush = 0;
+                }
+            }
+
+            if (drained == 0) {
+                if (stopping) {
+                    if (rings_version_.load(std::memory_order_acquire) == version) {
+                        break;
+                    }
+                    continue; // 停止前又有环注册，再处理一轮
+                }
+                if (active_flush == 0 && flush_requested_.load(std::memory_order_acquire) == done) {
+                    std::this_thread::sleep_for(idle_sleep_);
+                }
+            }
+        }
+    }
+
+public:
+    // fd: 输出文件描述符（不负责关闭）；ring_capacity: 每个线程环的记录数
+    explicit AsyncLogger(int fd = STDOUT_FILENO,
+                         size_t ring_capacity = 4096,
+                         LogFullPolicy policy = LogFullPolicy::Block,
+                         std::chrono::microseconds idle_sleep = std::chrono::microseconds(100),
+                         size_t drain_batch = 1024)
+        : fd_(fd),
+          ring_capacity_(ring_capacity),
+          policy_(policy),
+          idle_sleep_(idle_sleep),
+          drain_batch_(drain_batch),
+          logger_id_(nextLoggerId()) {
+        backend_ = std::thread([this]() { backendLoop(); });
+    }
+
+    ~AsyncLogger() {
+        stop_.store(true, std::memory_order_release);
+        backend_.join();
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        for (auto& ring : rings_) {
+            ring->logger_gone.store(true, std::memory_order_release);
+        }
+    }
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    // 任意线程：写一条日志。fmt 与 C 字符串参数必须在后端写出前保持有效（通常为字面量）
+    // 返回 false 表示环满且策略为 Drop
+    template<typename... Args>
+    bool log(const char* fmt, Args... args) {
+        static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "too many log arguments");
+        LogRecord record;
+        record.fmt = fmt;
+        record.nargs = sizeof...(Args);
+        size_t i = 0;
+        (void)i;
+        ((record.args[i++] = makeLogArg(args)), ...);
+
+        LogRing* ring = localRing();
+        while (!ring->queue.enqueue(record)) {
+            if (policy_ == LogFullPolicy::Drop) {
+                ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1,
+                                    std::memory_order_relaxed);
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        ring->logged.store(ring->logged.load(std::memory_order_relaxed) + 1,
+                           std::memory_order_release);
+        return true;
+    }
+
+    // 当前注册的环个数（线程退出且写完后减少）
+    size_t ring_count() {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        return rings_.size();
+    }
+
+    // 任意线程：等待调用前已入队的日志全部写出，其他线程持续写日志不会让它一直等待
+    void flush() {
+        uint64_t seq = flush_requested_.fetch_add(1, std::memory_order_acq_rel) + 1;
+        while (flush_done_.load(std::memory_order_acquire) < seq) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+#endif
@@ -3,6 +3,8 @@
 #include <iostream>
 #include "stack.h"
 #include "spsc_queue.h"
+#include "async_logger.h"
+#include "pipeline.h"
 
 void testLockFreeStack() {
     LockFreeStack<int> stack;
@@ -54,7 +56,8 @@ void testSpscQueue() {
     });
 
     std::atomic<int> counter(0);
-    threads.emplace_back([&spscQueue, &counter, &isStop]() {
+    AsyncLogger logger;
+    threads.emplace_back([&spscQueue, &counter, &isStop, &logger]() {
         while(1) {
             int res = -1;
             while (!spscQueue.dequeue(res)) {
@@ -63,7 +66,8 @@ void testSpscQueue() {
                 }
             }
 
-            std::cout << "dequeue item: " << res << std::endl;
+            // 热循环中不直接写 std::cout，交给后端线程格式化输出
+            logger.log("dequeue item: {}", res);
             if (res == -1) {
                 break;
             }
@@ -73,12 +77,40 @@ void testSpscQueue() {
     });
 
     for (auto& t : threads) t.join();
+    logger.flush();
 
     std::cout << "dqueue count: " << counter << std::endl;
 }
 
+void testPipeline() {
+    // 与 testSpscQueue 相同的生产-消费过程，由流水线负责队列、等待和流结束
+    AsyncLogger logger;
+    int next = 0;
+    int counter = 0;
+    auto pipeline = Pipeline::source<int>([&next](int& item) {
+            if (next == 1000) {
+                return false;
+            }
+            item = next++;
+            return true;
+        }, {"producer"})
+        .sink([&logger, &counter](int& item) {
+            logger.log("dequeue item: {}", item);
+            counter++;
+        }, {"consumer"});
+    pipeline.run();
+    logger.flush();
+
+    std::cout << "dqueue count: " << counter << std::endl;
+    for (const auto& st : pipeline.stats()) {
+        std::cout << st.name << ": " << st.throughput() << " items/s, queue depth "
+                  << st.queue_depth << std::endl;
+    }
+}
+
 int main() {
     // testLockFreeStack();
     testSpscQueue();
+    testPipeline();
     return 0;
 }
\ No newline at end of file
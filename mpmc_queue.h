@@ -0,0 +1,250 @@
+#ifndef __MPMC_QUEUE__
+#define __MPMC_QUEUE__
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+// 风险指针记录：每个线程占用一条，线程退出后置为空闲供其他线程复用
+struct HazardRecord {
+    static constexpr int HP_PER_THREAD = 2; // MS队列出队需要同时保护 head 和 head->next
+
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+    };
+
+    std::atomic<void*> hp[HP_PER_THREAD] = {};
+    std::atomic<bool> active{false};
+    HazardRecord* next = nullptr;
+    std::vector<Retired> retired; // 只由持有者线程访问
+};
+
+// 风险指针域：所有 MPMCQueue 共用，线程无需手动分配ID
+class HazardDomain {
+private:
+    std::atomic<HazardRecord*> head_{nullptr};
+    std::atomic<int> record_count_{0};
+
+    // 线程退出时归还记录，未回收的节点留给下一个持有者
+    struct LocalHolder {
+        HazardDomain* domain = nullptr;
+        HazardRecord* record = nullptr;
+
+        ~LocalHolder() {
+            if (record) {
+                for (auto& hp : record->hp) {
+                    hp.store(nullptr, std::memory_order_release);
+                }
+                domain->scan(record);
+                record->active.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    HazardRecord* acquireRecord() {
+        // 先尝试复用空闲记录
+        for (HazardRecord* r = head_.load(std::memory_order_acquire); r; r = r->next) {
+            bool expected = false;
+            if (!r->active.load(std::memory_order_relaxed) &&
+                r->active.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                return r;
+            }
+        }
+        HazardRecord* r = new HazardRecord();
+        r->active.store(true, std::memory_order_relaxed);
+        HazardRecord* old_head = head_.load(std::memory_order_relaxed);
+        do {
+            r->next = old_head;
+        } while (!head_.compare_exchange_weak(old_head, r, std::memory_order_release,
+                                              std::memory_order_relaxed));
+        record_count_.fetch_add(1, std::memory_order_relaxed);
+        return r;
+    }
+
+public:
+    static HazardDomain& instance() {
+        static HazardDomain domain;
+        return domain;
+    }
+
+    ~HazardDomain() {
+        // 进程退出时所有线程都已结束，直接释放
+        HazardRecord* r = head_.load(std::memory_order_acquire);
+        while (r) {
+            for (auto& item : r->retired) {
+                item.deleter(item.ptr);
+            }
+            HazardRecord* next = r->next;
+            delete r;
+            r = next;
+        }
+    }
+
+    HazardRecord* localRecord() {
+        static thread_local LocalHolder holder;
+        if (!holder.record) {
+            holder.domain = this;
+            holder.record = acquireRecord();
+        }
+        return holder.record;
+    }
+
+    // 发布风险指针并确认 src 在发布后没有变化
+    template<typename N>
+    N* protect(int index, const std::atomic<N*>& src) {
+        std::atomic<void*>& hp = localRecord()->hp[index];
+        N* ptr = src.load(std::memory_order_acquire);
+        while (true) {
+            hp.store(ptr, std::memory_order_seq_cst);
+            N* current = src.load(std::memory_order_seq_cst);
+            if (current == ptr) {
+                return ptr;
+            }
+            ptr = current;
+        }
+    }
+
+    void clear(int index) {
+        localRecord()->hp[index].store(nullptr, std::memory_order_release);
+    }
+
+    // 退休节点，累计到阈值后扫描所有风险指针批量回收
+    template<typename N>
+    void retire(N* node) {
+        HazardRecord* record = localRecord();
+        record->retired.push_back({node, [](void* p) { delete static_cast<N*>(p); }});
+        const size_t threshold = std::max<size_t>(
+            64, 2 * HazardRecord::HP_PER_THREAD * record_count_.load(std::memory_order_relaxed));
+        if (record->retired.size() >= threshold) {
+            scan(record);
+        }
+    }
+
+    void scan(HazardRecord* record) {
+        std::vector<void*> hazards;
+        for (HazardRecord* r = head_.load(std::memory_order_acquire); r; r = r->next) {
+            for (auto& hp : r->hp) {
+                void* p = hp.load(std::memory_order_seq_cst);
+                if (p) {
+                    hazards.push_back(p);
+                }
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        std::vector<HazardRecord::Retired> remaining;
+        for (auto& item : record->retired) {
+            if (std::binary_search(hazards.begin(), hazards.end(), item.ptr)) {
+                remaining.push_back(item); // 仍被引用，下次再试
+            } else {
+                item.deleter(item.ptr);
+            }
+        }
+        record->retired.swap(remaining);
+    }
+};
+
+template<typename T>
+struct MPMCNode {
+    T data;
+    std::atomic<MPMCNode*> next{nullptr};
+
+    MPMCNode() = default;
+    explicit MPMCNode(T data) : data(std::move(data)) {}
+};
+
+// 无界MPMC队列（Michael-Scott 队列 + 风险指针回收）
+// 任意线程都可以入队和出队，不需要传入线程ID
+template<typename T>
+class MPMCQueue {
+private:
+    alignas(64) std::atomic<MPMCNode<T>*> head_;
+    alignas(64) std::atomic<MPMCNode<T>*> tail_;
+
+    static HazardDomain& domain() {
+        return HazardDomain::instance();
+    }
+
+public:
+    MPMCQueue() {
+        // 哑节点，用于简化边界条件处理
+        MPMCNode<T>* dummy = new MPMCNode<T>();
+        head_.store(dummy, std::memory_order_relaxed);
+        tail_.store(dummy, std::memory_order_relaxed);
+    }
+
+    // 析构时不能有并发访问
+    ~MPMCQueue() {
+        MPMCNode<T>* node = head_.load(std::memory_order_relaxed);
+        while (node) {
+            MPMCNode<T>* next = node->next.load(std::memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    void enqueue(T data) {
+        MPMCNode<T>* new_node = new MPMCNode<T>(std::move(data));
+        while (true) {
+            MPMCNode<T>* tail = domain().protect(0, tail_);
+            MPMCNode<T>* next = tail->next.load(std::memory_order_acquire);
+            if (tail != tail_.load(std::memory_order_acquire)) {
+                continue;
+            }
+            if (next != nullptr) {
+                // tail 落后，帮助推进
+                tail_.compare_exchange_weak(tail, next, std::memory_order_release,
+                                            std::memory_order_relaxed);
+                continue;
+            }
+            MPMCNode<T>* expected = nullptr;
+            if (tail->next.compare_exchange_weak(expected, new_node, std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+                // 链接成功，尝试推进 tail，失败说明已有其他线程帮忙推进
+                tail_.compare_exchange_strong(tail, new_node, std::memory_order_release,
+                                              std::memory_order_relaxed);
+                break;
+            }
+        }
+        domain().clear(0);
+    }
+
+    bool dequeue(T& result) {
+        while (true) {
+            MPMCNode<T>* head = domain().protect(0, head_);
+            MPMCNode<T>* tail = tail_.load(std::memory_order_acquire);
+            MPMCNode<T>* next = domain().protect(1, head->next);
+            if (head != head_.load(std::memory_order_acquire)) {
+                continue;
+            }
+            if (next == nullptr) {
+                // 队列为空
+                domain().clear(0);
+                domain().clear(1);
+                return false;
+            }
+            if (head == tail) {
+                // tail 落后，帮助推进
+                tail_.compare_exchange_weak(tail, next, std::memory_order_release,
+                                            std::memory_order_relaxed);
+                continue;
+            }
+            if (head_.compare_exchange_weak(head, next, std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+                // next 成为新的哑节点，只有出队成功的线程读取它的数据
+                result = std::move(next->data);
+                domain().clear(0);
+                domain().clear(1);
+                domain().retire(head);
+                return true;
+            }
+        }
+    }
+};
+
+#endif
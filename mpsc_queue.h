@@ -22,6 +22,7 @@ template<typename T>
 struct Node {
     T data;
     std::atomic<TaggedPtr<Node>> next; // 下一个节点也是标记指针
+    uint64_t seq = 0;                  // 入队序号，仅 DropOldest 策略使用
 
     Node(T data) : data(std::move(data)) {
         next.store({{nullptr}, 0}, std::memory_order_relaxed);
@@ -59,7 +60,32 @@ public:
 template<typename T>
 HazardPointerRegistry<T> gp_hp_registry;
 
+// 有界队列满时的处理策略
+enum class OverflowPolicy {
+    Block,      // enqueue 等待消费者腾出空间
+    DropNewest, // 丢弃正在入队的新元素
+    // 丢弃最旧的元素：每个元素带生产者递增的序号，消费者跳过其后已有 capacity 个
+    // 更新元素的旧元素。生产者无法摘除链表节点，为限制内存，链表达到2倍容量时
+    // 退化为丢弃新元素（消费者长时间停滞时才会出现），同样计入 dropped()
+    DropOldest,
+};
+
+// 生产者计数分片，按线程分配，避免所有生产者争用同一缓存行
+struct alignas(64) SizeShard {
+    std::atomic<uint64_t> enqueued{0};
+};
+
+static constexpr size_t MPSC_SIZE_SHARDS = 8;
+
+inline size_t mpscShardIndex() {
+    static std::atomic<size_t> next_shard{0};
+    static thread_local const size_t shard =
+        next_shard.fetch_add(1, std::memory_order_relaxed) % MPSC_SIZE_SHARDS;
+    return shard;
+}
+
 // MPSC队列主类
+// capacity 为0时无界（不维护元素计数）；否则按近似元素个数限流，超出量不超过并发生产者个数
 template<typename T>
 class MPSCQueue {
 private:
@@ -67,23 +93,22 @@ private:
     alignas(64) std::atomic<TaggedPtr<Node<T>>> tail_;
     // 哑节点，用于简化边界条件处理
     alignas(64) Node<T>* dummy_head_;
+    // 消费者出队计数，只由消费者写
+    alignas(64) std::atomic<uint64_t> dequeued_{0};
+    // DropOldest 策略下的入队序号
+    alignas(64) std::atomic<uint64_t> next_seq_{0};
+    alignas(64) std::atomic<uint64_t> dropped_{0};
+    SizeShard shards_[MPSC_SIZE_SHARDS];
 
-public:
-    MPSCQueue() {
-        // 初始化时创建一个哑节点
-        dummy_head_ = new Node<T>(T{});
-        tail_.store({{dummy_head_}, 0}, std::memory_order_relaxed);
-    }
-
-    ~MPSCQueue() {
-        // 简单遍历释放所有节点，生产环境中需更安全的方式
-        TaggedPtr<Node<T>> curr = tail_.load(std::memory_order_relaxed);
-        delete curr.ptr;
-    }
+    const size_t capacity_;
+    const OverflowPolicy policy_;
 
-    // 生产者：入队操作
-    void enqueue(T data){
+    // 无条件入队
+    void push(T data){
         Node<T>* new_node = new Node<T>(std::move(data));
+        if (policy_ == OverflowPolicy::DropOldest) {
+            new_node->seq = next_seq_.fetch_add(1, std::memory_order_relaxed);
+        }
         TaggedPtr<Node<T>> old_tail = tail_.load(std::memory_order_relaxed);
 
         while (true) {
@@ -103,10 +128,116 @@ public:
             }
             // CAS失败，old_tail已被更新为最新值，循环重试
         }
+        if (capacity_ != 0) {
+            shards_[mpscShardIndex()].enqueued.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
-    // 消费者：出队操作
+    // 链表中实际的节点个数（含 DropOldest 下等待跳过的旧元素）
+    uint64_t linkedSize() const {
+        uint64_t enqueued = 0;
+        for (const SizeShard& shard : shards_) {
+            enqueued += shard.enqueued.load(std::memory_order_relaxed);
+        }
+        uint64_t dequeued = dequeued_.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    // 消费者：DropOldest 下该元素之后已有 capacity 个更新的元素，应当丢弃
+    bool superseded(uint64_t seq) const {
+        return policy_ == OverflowPolicy::DropOldest &&
+               seq + capacity_ < next_seq_.load(std::memory_order_relaxed);
+    }
+
+public:
+    explicit MPSCQueue(size_t capacity = 0, OverflowPolicy policy = OverflowPolicy::Block)
+        : capacity_(capacity), policy_(policy) {
+        // 初始化时创建一个哑节点
+        dummy_head_ = new Node<T>(T{});
+        tail_.store({{dummy_head_}, 0}, std::memory_order_relaxed);
+    }
+
+    ~MPSCQueue() {
+        // 简单遍历释放所有节点，生产环境中需更安全的方式
+        TaggedPtr<Node<T>> curr = tail_.load(std::memory_order_relaxed);
+        delete curr.ptr;
+    }
+
+    // 生产者：入队操作
+    // 有界队列满时按策略处理：Block 等待空间；DropNewest 丢弃data并返回false；
+    // DropOldest 总是入队，旧元素由消费者跳过（链表达到2倍容量时丢弃data并返回false）
+    bool enqueue(T data){
+        if (capacity_ == 0) {
+            push(std::move(data));
+            return true;
+        }
+
+        if (policy_ == OverflowPolicy::DropOldest) {
+            if (linkedSize() >= 2 * capacity_) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            push(std::move(data));
+            return true;
+        }
+
+        while (size_approx() >= capacity_) {
+            switch (policy_) {
+            case OverflowPolicy::Block:
+                std::this_thread::yield();
+                continue;
+            case OverflowPolicy::DropNewest:
+            case OverflowPolicy::DropOldest:
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        push(std::move(data));
+        return true;
+    }
+
+    // 生产者：队列满时直接失败，不受溢出策略影响
+    bool try_enqueue(T data){
+        if (capacity_ != 0 && size_approx() >= capacity_) {
+            return false;
+        }
+        push(std::move(data));
+        return true;
+    }
+
+    // 近似元素个数：并发修改时只是一个快照；无界队列不计数，总是返回0
+    size_t size_approx() const {
+        uint64_t size = linkedSize();
+        if (policy_ == OverflowPolicy::DropOldest && capacity_ != 0 && size > capacity_) {
+            return capacity_; // 超出部分会被消费者跳过
+        }
+        return size;
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    // 因队列满被丢弃的元素个数
+    uint64_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    // 消费者：出队操作（跳过 DropOldest 策略下被丢弃的旧元素）
+    // 只允许一个消费者线程；多个消费者请使用 mpmc_queue.h 中的 MPMCQueue
     bool dequeue(T& result, int consumer_thread_id){
+        uint64_t seq;
+        while (dequeueOne(result, seq, consumer_thread_id)) {
+            if (!superseded(seq)) {
+                return true;
+            }
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return false;
+    }
+
+private:
+    bool dequeueOne(T& result, uint64_t& seq, int consumer_thread_id){
         // 获取本线程的风险指针
         std::atomic<Node<T>*>& hp = gp_hp_registry<T>.acquire(consumer_thread_id);
 
@@ -139,12 +270,17 @@ public:
                                                          std::memory_order_acq_rel)) {
                 // 出队成功
                 result = std::move(old_next.ptr->data);
+                seq = old_next.ptr->seq;
                 hp.store(nullptr, std::memory_order_release); // 释放风险指针
 
                 // 将旧头节点（哑节点）放入回收列表，稍后由风险指针机制回收
                 gp_hp_registry<T>.reclaim(old_head);
                 // 设置新的哑节点
                 dummy_head_ = old_next.ptr;
+                if (capacity_ != 0) {
+                    dequeued_.store(dequeued_.load(std::memory_order_relaxed) + 1,
+                                    std::memory_order_relaxed);
+                }
                 return true;
             }
         }
@@ -0,0 +1,388 @@
+#ifndef __PIPELINE__
+#define __PIPELINE__
+
+#include <pthread.h>
+#include <sched.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "spsc_queue.h"
+
+// 单个阶段的配置
+struct StageOptions {
+    std::string name;
+    int cpu = -1;                // 绑定的CPU，-1表示不绑定
+    size_t batch_size = 64;      // 每次交接的元素个数
+    size_t queue_capacity = 1024; // 本阶段输出队列容量
+};
+
+// batch_size 为0时源阶段永远交接空批，queue_capacity 为0时通道永远满，都至少取1
+inline StageOptions normalizeStageOptions(StageOptions options) {
+    if (options.batch_size == 0) {
+        options.batch_size = 1;
+    }
+    if (options.queue_capacity == 0) {
+        options.queue_capacity = 1;
+    }
+    return options;
+}
+
+// 源函数的返回状态
+enum class SourceStatus {
+    Ready, // 产出了一个元素
+    Idle,  // 暂时没有数据：已攒的不满一批也先交给下游
+    End,   // 流结束
+};
+
+// 源函数也可以返回 bool：true 等价于 Ready，false 等价于 End
+inline SourceStatus toSourceStatus(bool more) {
+    return more ? SourceStatus::Ready : SourceStatus::End;
+}
+
+inline SourceStatus toSourceStatus(SourceStatus status) {
+    return status;
+}
+
+// 单个阶段的运行统计
+struct StageStats {
+    std::string name;
+    uint64_t items = 0;        // 已处理元素个数
+    uint64_t input_waits = 0;  // 输入队列为空而等待的次数（上游慢）
+    uint64_t output_waits = 0; // 输出队列已满而等待的次数（下游慢）
+    size_t queue_depth = 0;    // 输出队列当前深度（sink为0）
+    double seconds = 0;        // 从启动到结束（或到现在）的时间
+    bool pinned = false;       // 是否已绑定到 StageOptions::cpu（未指定或绑定失败为false）
+
+    double throughput() const {
+        return seconds > 0 ? items / seconds : 0;
+    }
+};
+
+// 等待策略：先自旋，再让出CPU
+inline void pipelineBackoff(unsigned& spins) {
+    if (++spins > 16) {
+        std::this_thread::yield();
+    }
+}
+
+// 每个阶段线程各自写的计数，统计线程只读
+struct alignas(64) StageCounters {
+    std::atomic<uint64_t> items{0};
+    std::atomic<uint64_t> input_waits{0};
+    std::atomic<uint64_t> output_waits{0};
+    std::atomic<int64_t> finished_ns{0}; // 结束时间（相对启动），0表示仍在运行
+    std::atomic<bool> pinned{false};
+
+    static void add(std::atomic<uint64_t>& counter, uint64_t n) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+};
+
+// 阶段之间的通道：SPSCQueue + 关闭标记，取代 "-1" 哨兵
+template<typename T>
+class Channel {
+private:
+    SPSCQueue<T> queue_;
+    alignas(64) std::atomic<bool> closed_{false};
+
+public:
+    explicit Channel(size_t capacity) : queue_(capacity) {}
+
+    // 生产者：整批写入，队满时等待
+    void push(const T* items, size_t count, StageCounters& counters) {
+        unsigned spins = 0;
+        while (count > 0) {
+            size_t n = queue_.enqueue_bulk(items, count);
+            if (n == 0) {
+                StageCounters::add(counters.output_waits, 1);
+                pipelineBackoff(spins);
+                continue;
+            }
+            spins = 0;
+            items += n;
+            count -= n;
+        }
+    }
+
+    // 生产者：流结束，之前写入的元素对消费者可见后才会观察到关闭
+    void close() {
+        closed_.store(true, std::memory_order_release);
+    }
+
+    // 消费者：最多取 max_count 个，返回0表示流结束
+    size_t pop(T* items, size_t max_count, StageCounters& counters) {
+        unsigned spins = 0;
+        while (true) {
+            size_t n = queue_.dequeue_bulk(items, max_count);
+            if (n > 0) {
+                return n;
+            }
+            if (closed_.load(std::memory_order_acquire)) {
+                // 关闭前写入的元素此时一定可见，再取一次
+                return queue_.dequeue_bulk(items, max_count);
+            }
+            StageCounters::add(counters.input_waits, 1);
+            pipelineBackoff(spins);
+        }
+    }
+
+    size_t depth() const {
+        return queue_.size();
+    }
+};
+
+class StageBase {
+public:
+    explicit StageBase(StageOptions options) : options_(std::move(options)) {}
+    virtual ~StageBase() = default;
+
+    virtual void run() = 0;
+    virtual size_t outputDepth() const = 0;
+
+    StageOptions options_;
+    StageCounters counters_;
+    std::thread thread_;
+};
+
+// 源阶段：fn(T&) 返回 SourceStatus 或 bool（false表示流结束）
+template<typename T, typename F>
+class SourceStage : public StageBase {
+public:
+    SourceStage(F fn, StageOptions options, std::shared_ptr<Channel<T>> out)
+        : StageBase(std::move(options)), fn_(std::move(fn)), out_(std::move(out)) {}
+
+    void run() override {
+        std::vector<T> batch(options_.batch_size);
+        SourceStatus status = SourceStatus::Ready;
+        unsigned spins = 0;
+        while (status != SourceStatus::End) {
+            size_t n = 0;
+            while (n < batch.size() &&
+                   (status = toSourceStatus(fn_(batch[n]))) == SourceStatus::Ready) {
+                ++n;
+            }
+            if (n > 0) {
+                out_->push(batch.data(), n, counters_);
+                StageCounters::add(counters_.items, n);
+                spins = 0;
+            } else if (status == SourceStatus::Idle) {
+                StageCounters::add(counters_.input_waits, 1);
+                pipelineBackoff(spins);
+            }
+        }
+        out_->close();
+    }
+
+    size_t outputDepth() const override {
+        return out_->depth();
+    }
+
+private:
+    F fn_;
+    std::shared_ptr<Channel<T>> out_;
+};
+
+// 变换阶段：Out fn(In&)
+template<typename In, typename Out, typename F>
+class TransformStage : public StageBase {
+public:
+    TransformStage(F fn, StageOptions options,
+                   std::shared_ptr<Channel<In>> in, std::shared_ptr<Channel<Out>> out)
+        : StageBase(std::move(options)), fn_(std::move(fn)), in_(std::move(in)), out_(std::move(out)) {}
+
+    void run() override {
+        std::vector<In> input(options_.batch_size);
+        std::vector<Out> output(options_.batch_size);
+        size_t n;
+        while ((n = in_->pop(input.data(), input.size(), counters_)) > 0) {
+            for (size_t i = 0; i < n; ++i) {
+                output[i] = fn_(input[i]);
+            }
+            out_->push(output.data(), n, counters_);
+            StageCounters::add(counters_.items, n);
+        }
+        out_->close();
+    }
+
+    size_t outputDepth() const override {
+        return out_->depth();
+    }
+
+private:
+    F fn_;
+    std::shared_ptr<Channel<In>> in_;
+    std::shared_ptr<Channel<Out>> out_;
+};
+
+// 汇阶段：fn(In&)
+template<typename In, typename F>
+class SinkStage : public StageBase {
+public:
+    SinkStage(F fn, StageOptions options, std::shared_ptr<Channel<In>> in)
+        : StageBase(std::move(options)), fn_(std::move(fn)), in_(std::move(in)) {}
+
+    void run() override {
+        std::vector<In> input(options_.batch_size);
+        size_t n;
+        while ((n = in_->pop(input.data(), input.size(), counters_)) > 0) {
+            for (size_t i = 0; i < n; ++i) {
+                fn_(input[i]);
+            }
+            StageCounters::add(counters_.items, n);
+        }
+    }
+
+    size_t outputDepth() const override {
+        return 0;
+    }
+
+private:
+    F fn_;
+    std::shared_ptr<Channel<In>> in_;
+};
+
+template<typename T>
+class PipelineBuilder;
+
+// 流水线：每个阶段一个线程，相邻阶段之间用 SPSCQueue 批量交接
+// 用法：
+//   auto p = Pipeline::source<int>(gen, {"gen"}).then(parse, {"parse", 1}).sink(store, {"store", 2});
+//   p.run();
+class Pipeline {
+public:
+    template<typename T, typename F>
+    static PipelineBuilder<T> source(F fn, StageOptions options = {});
+
+    Pipeline() = default;
+    Pipeline(Pipeline&&) = default;
+    Pipeline& operator=(Pipeline&&) = delete;
+
+    ~Pipeline() {
+        wait();
+    }
+
+    // 启动所有阶段线程
+    void start() {
+        start_time_ = std::chrono::steady_clock::now();
+        const auto start_time = start_time_;
+        for (auto& stage : stages_) {
+            StageBase* s = stage.get();
+            s->thread_ = std::thread([s, start_time]() {
+                // 在处理第一批之前绑定，失败时通过 stats().pinned 报告
+                s->counters_.pinned.store(pinCurrentThread(s->options_.cpu),
+                                          std::memory_order_relaxed);
+                s->run();
+                int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start_time).count();
+                s->counters_.finished_ns.store(ns > 0 ? ns : 1, std::memory_order_relaxed);
+            });
+        }
+    }
+
+    // 等待流结束传播到最后一个阶段
+    void wait() {
+        for (auto& stage : stages_) {
+            if (stage->thread_.joinable()) {
+                stage->thread_.join();
+            }
+        }
+    }
+
+    void run() {
+        start();
+        wait();
+    }
+
+    // 任意线程：各阶段统计，queue_depth 最大、output_waits 多的阶段下游即为瓶颈
+    std::vector<StageStats> stats() const {
+        std::vector<StageStats> result;
+        for (const auto& stage : stages_) {
+            StageStats st;
+            st.name = stage->options_.name;
+            st.items = stage->counters_.items.load(std::memory_order_relaxed);
+            st.input_waits = stage->counters_.input_waits.load(std::memory_order_relaxed);
+            st.output_waits = stage->counters_.output_waits.load(std::memory_order_relaxed);
+            st.queue_depth = stage->outputDepth();
+            st.pinned = stage->counters_.pinned.load(std::memory_order_relaxed);
+            int64_t ns = stage->counters_.finished_ns.load(std::memory_order_relaxed);
+            st.seconds = (ns != 0 ? ns : elapsedNs()) / 1e9;
+            result.push_back(st);
+        }
+        return result;
+    }
+
+private:
+    template<typename T>
+    friend class PipelineBuilder;
+
+    std::vector<std::unique_ptr<StageBase>> stages_;
+    std::chrono::steady_clock::time_point start_time_;
+
+    int64_t elapsedNs() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_time_).count();
+    }
+
+    // 绑定当前线程，返回是否成功；失败（CPU不存在等）时保持不绑定运行
+    static bool pinCurrentThread(int cpu) {
+        if (cpu < 0) {
+            return false;
+        }
+#ifdef __linux__
+        if (cpu >= CPU_SETSIZE) {
+            return false;
+        }
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(cpu, &cpuset);
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) == 0;
+#else
+        return false;
+#endif
+    }
+};
+
+// 构建器：记录最后一个阶段的输出通道，then 追加变换阶段，sink 结束构建
+template<typename T>
+class PipelineBuilder {
+public:
+    PipelineBuilder(Pipeline pipeline, std::shared_ptr<Channel<T>> tail)
+        : pipeline_(std::move(pipeline)), tail_(std::move(tail)) {}
+
+    template<typename F, typename Out = typename std::decay<decltype(std::declval<F&>()(std::declval<T&>()))>::type>
+    PipelineBuilder<Out> then(F fn, StageOptions options = {}) {
+        options = normalizeStageOptions(std::move(options));
+        auto out = std::make_shared<Channel<Out>>(options.queue_capacity);
+        pipeline_.stages_.emplace_back(
+            new TransformStage<T, Out, F>(std::move(fn), std::move(options), tail_, out));
+        return PipelineBuilder<Out>(std::move(pipeline_), out);
+    }
+
+    template<typename F>
+    Pipeline sink(F fn, StageOptions options = {}) {
+        options = normalizeStageOptions(std::move(options));
+        pipeline_.stages_.emplace_back(
+            new SinkStage<T, F>(std::move(fn), std::move(options), tail_));
+        return std::move(pipeline_);
+    }
+
+private:
+    Pipeline pipeline_;
+    std::shared_ptr<Channel<T>> tail_;
+};
+
+template<typename T, typename F>
+PipelineBuilder<T> Pipeline::source(F fn, StageOptions options) {
+    options = normalizeStageOptions(std::move(options));
+    auto out = std::make_shared<Channel<T>>(options.queue_capacity);
+    Pipeline pipeline;
+    pipeline.stages_.emplace_back(new SourceStage<T, F>(std::move(fn), std::move(options), out));
+    return PipelineBuilder<T>(std::move(pipeline), out);
+}
+
+#endif
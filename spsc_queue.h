@@ -15,7 +15,9 @@ private:
     alignas(64) std::atomic<size_t> tail_ {0};
 
     size_t next_(size_t current) const {
-        return (current + 1) % buffer_.size();
+        // 用比较代替取模，避免热路径上的除法
+        const size_t next = current + 1;
+        return next == buffer_.size() ? 0 : next;
     }
 
 public:
@@ -54,6 +56,51 @@ public:
         head_.store(next_head, std::memory_order_release);
         return true;
     }
+
+    // 生产者调用：批量入队，最多写入 count 个，只发布一次 tail_，返回实际入队个数
+    size_t enqueue_bulk(const T* items, size_t count) {
+        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+        const size_t current_head = head_.load(std::memory_order_acquire);
+        const size_t size = buffer_.size();
+        const size_t free_slots = (current_head + size - current_tail - 1) % size;
+        const size_t n = count < free_slots ? count : free_slots;
+
+        size_t pos = current_tail;
+        for (size_t i = 0; i < n; ++i) {
+            buffer_[pos] = items[i];
+            pos = next_(pos);
+        }
+        if (n > 0) {
+            tail_.store(pos, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // 消费者调用：批量出队，最多取出 max_count 个，只发布一次 head_，返回实际出队个数
+    size_t dequeue_bulk(T* items, size_t max_count) {
+        const size_t current_head = head_.load(std::memory_order_relaxed);
+        const size_t current_tail = tail_.load(std::memory_order_acquire);
+        const size_t size = buffer_.size();
+        const size_t available = (current_tail + size - current_head) % size;
+        const size_t n = max_count < available ? max_count : available;
+
+        size_t pos = current_head;
+        for (size_t i = 0; i < n; ++i) {
+            items[i] = buffer_[pos];
+            pos = next_(pos);
+        }
+        if (n > 0) {
+            head_.store(pos, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // 任意线程：近似元素个数
+    size_t size() const {
+        const size_t current_head = head_.load(std::memory_order_acquire);
+        const size_t current_tail = tail_.load(std::memory_order_acquire);
+        return (current_tail + buffer_.size() - current_head) % buffer_.size();
+    }
 };
 
 #endif
\ No newline at end of file
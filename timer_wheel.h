@@ -0,0 +1,395 @@
+#ifndef __TIMER_WHEEL__
+#define __TIMER_WHEEL__
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "mpsc_queue.h"
+
+// 定时器命令：其他线程通过收件箱提交给拥有者线程
+template<typename T>
+struct TimerCommand {
+    enum Op : uint8_t { ADD, CANCEL };
+
+    Op op = ADD;
+    uint64_t id = 0;
+    uint64_t expires = 0;
+    T payload{};
+};
+
+// 分层时间轮（单线程拥有）
+// - 任意线程调用 schedule_at/schedule_after/cancel，命令写入 MPSCQueue 收件箱，不加锁
+// - 拥有者线程调用 advance，每次先批量取空收件箱，再按tick推进时间轮
+// - 插入和取消均为 O(1)：桶是以下标串起来的双向链表，节点放在分段的节点池中；
+//   TimerId 由节点下标和代数组成，生产者入队前就从空闲栈取得节点，取消时直接按下标访问
+// 同一个线程先 schedule 后 cancel 的顺序由收件箱保证；跨线程取消一个尚未被
+// 拥有者取出的定时器，或取消一个已经到期的定时器，都是空操作。
+template<typename T>
+class TimerWheel {
+public:
+    using TimerId = uint64_t;
+
+private:
+    // 第0层256个槽，其余4层各64个槽，共覆盖 2^32 个tick（与Linux经典时间轮相同）
+    static constexpr int ROOT_BITS = 8;
+    static constexpr int LEVEL_BITS = 6;
+    static constexpr int LEVELS = 5;
+    static constexpr uint32_t ROOT_SIZE = 1u << ROOT_BITS;
+    static constexpr uint32_t LEVEL_SIZE = 1u << LEVEL_BITS;
+    static constexpr uint64_t ROOT_MASK = ROOT_SIZE - 1;
+    static constexpr uint64_t LEVEL_MASK = LEVEL_SIZE - 1;
+    static constexpr uint32_t BUCKET_COUNT = ROOT_SIZE + (LEVELS - 1) * LEVEL_SIZE;
+    static constexpr uint64_t MAX_SPAN = (1ull << (ROOT_BITS + (LEVELS - 1) * LEVEL_BITS)) - 1;
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    // 节点池分段：第k段有 SEGMENT_BASE << k 个节点，段一经分配不再移动，生产者可以并发访问
+    static constexpr int SEGMENT_BASE_BITS = 10;
+    static constexpr uint64_t SEGMENT_BASE = 1ull << SEGMENT_BASE_BITS;
+    static constexpr int SEGMENTS = 33 - SEGMENT_BASE_BITS;
+
+    struct TimerNode {
+        uint64_t expires = 0;
+        uint32_t prev = NIL;
+        uint32_t next = NIL;
+        uint32_t bucket = 0;
+        uint32_t gen = 1;        // 每次释放加1，旧的 TimerId 随之失效
+        bool live = false;       // 已由拥有者插入时间轮
+        std::atomic<uint32_t> free_next{NIL}; // 空闲栈链接，生产者出栈时并发读取
+        T payload{};
+    };
+
+    // 跨线程共享部分
+    MPSCQueue<TimerCommand<T>> inbox_;
+    std::atomic<TimerNode*> segments_[SEGMENTS] = {};
+    alignas(64) std::atomic<uint64_t> free_head_{NIL}; // 空闲栈：高32位为防ABA标签，低32位为下标
+    alignas(64) std::atomic<uint32_t> next_fresh_{0};  // 从未使用过的下一个下标
+    alignas(64) std::atomic<uint64_t> now_;  // 拥有者发布的当前tick，供 schedule_after 读取
+
+    // 以下仅由拥有者线程访问
+    alignas(64) uint64_t current_;           // 下一个待处理的tick
+    int owner_thread_id_;
+    std::vector<uint32_t> buckets_;          // 每个桶的链表头
+    size_t live_count_ = 0;                  // 时间轮中的定时器数量
+
+    static TimerId makeId(uint32_t idx, uint32_t gen) {
+        return (static_cast<uint64_t>(gen) << 32) | idx;
+    }
+
+    static int segmentOf(uint32_t idx, uint64_t& offset) {
+        const uint64_t v = static_cast<uint64_t>(idx) + SEGMENT_BASE;
+        const int seg = 63 - __builtin_clzll(v) - SEGMENT_BASE_BITS;
+        offset = v - (1ull << (seg + SEGMENT_BASE_BITS));
+        return seg;
+    }
+
+    // 下标所在的段必须已经分配
+    TimerNode& node(uint32_t idx) const {
+        uint64_t offset;
+        const int seg = segmentOf(idx, offset);
+        return segments_[seg].load(std::memory_order_acquire)[offset];
+    }
+
+    void ensureSegment(int seg) {
+        if (segments_[seg].load(std::memory_order_acquire) != nullptr) {
+            return;
+        }
+        TimerNode* fresh = new TimerNode[SEGMENT_BASE << seg];
+        TimerNode* expected = nullptr;
+        if (!segments_[seg].compare_exchange_strong(expected, fresh, std::memory_order_acq_rel)) {
+            delete[] fresh; // 其他线程已经分配
+        }
+    }
+
+    // 任意线程：取一个空闲节点下标，优先复用拥有者释放的节点
+    uint32_t acquireSlot() {
+        uint64_t head = free_head_.load(std::memory_order_acquire);
+        while (static_cast<uint32_t>(head) != NIL) {
+            const uint32_t idx = static_cast<uint32_t>(head);
+            const uint32_t next = node(idx).free_next.load(std::memory_order_relaxed);
+            const uint64_t new_head = (((head >> 32) + 1) << 32) | next;
+            if (free_head_.compare_exchange_weak(head, new_head, std::memory_order_acquire,
+                                                 std::memory_order_acquire)) {
+                return idx;
+            }
+        }
+        const uint32_t idx = next_fresh_.fetch_add(1, std::memory_order_relaxed);
+        uint64_t offset;
+        ensureSegment(segmentOf(idx, offset));
+        return idx;
+    }
+
+    // 拥有者线程：节点失效并放回空闲栈
+    void releaseSlot(uint32_t idx) {
+        TimerNode& n = node(idx);
+        n.payload = T{};
+        n.live = false;
+        ++n.gen;
+        uint64_t head = free_head_.load(std::memory_order_relaxed);
+        uint64_t new_head;
+        do {
+            n.free_next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            new_head = (((head >> 32) + 1) << 32) | idx;
+        } while (!free_head_.compare_exchange_weak(head, new_head, std::memory_order_release,
+                                                   std::memory_order_relaxed));
+    }
+
+    uint32_t bucketFor(uint64_t expires) const {
+        if (expires < current_) {
+            // 已经过期，放到当前槽，下一次推进即触发
+            return static_cast<uint32_t>(current_ & ROOT_MASK);
+        }
+        uint64_t delta = expires - current_;
+        if (delta < ROOT_SIZE) {
+            return static_cast<uint32_t>(expires & ROOT_MASK);
+        }
+        if (delta > MAX_SPAN) {
+            // 超出覆盖范围，先挂在最高层，级联时会按真实到期时间重新放置
+            expires = current_ + MAX_SPAN;
+            delta = MAX_SPAN;
+        }
+        for (int level = 1; level < LEVELS; ++level) {
+            const int shift = ROOT_BITS + level * LEVEL_BITS;
+            if (level == LEVELS - 1 || delta < (1ull << shift)) {
+                const int slot_shift = shift - LEVEL_BITS;
+                return ROOT_SIZE + (level - 1) * LEVEL_SIZE +
+                       static_cast<uint32_t>((expires >> slot_shift) & LEVEL_MASK);
+            }
+        }
+        return 0; // 不可达
+    }
+
+    void link(uint32_t idx) {
+        TimerNode& n = node(idx);
+        n.bucket = bucketFor(n.expires);
+        n.prev = NIL;
+        n.next = buckets_[n.bucket];
+        if (n.next != NIL) {
+            node(n.next).prev = idx;
+        }
+        buckets_[n.bucket] = idx;
+    }
+
+    void unlink(uint32_t idx) {
+        TimerNode& n = node(idx);
+        if (n.prev != NIL) {
+            node(n.prev).next = n.next;
+        } else {
+            buckets_[n.bucket] = n.next;
+        }
+        if (n.next != NIL) {
+            node(n.next).prev = n.prev;
+        }
+    }
+
+    // 取下整条桶链表，调用方逐个处理
+    uint32_t detachBucket(uint32_t bucket) {
+        uint32_t head = buckets_[bucket];
+        buckets_[bucket] = NIL;
+        return head;
+    }
+
+    void cascade(int level) {
+        const int slot_shift = ROOT_BITS + (level - 1) * LEVEL_BITS;
+        const uint32_t bucket = ROOT_SIZE + (level - 1) * LEVEL_SIZE +
+                                static_cast<uint32_t>((current_ >> slot_shift) & LEVEL_MASK);
+        uint32_t idx = detachBucket(bucket);
+        while (idx != NIL) {
+            uint32_t next = node(idx).next;
+            link(idx);
+            idx = next;
+        }
+    }
+
+    bool bucketEmpty(int level, uint32_t slot) const {
+        const uint32_t bucket = level == 0 ? slot : ROOT_SIZE + (level - 1) * LEVEL_SIZE + slot;
+        return buckets_[bucket] == NIL;
+    }
+
+    // 下一个需要处理的tick的保守下界（触发或级联），用于跳过空槽
+    uint64_t nextWorkTick() const {
+        uint64_t base = current_;
+        for (int level = 0; level < LEVELS; ++level) {
+            const int shift = level == 0 ? 0 : ROOT_BITS + (level - 1) * LEVEL_BITS;
+            const uint32_t size = level == 0 ? ROOT_SIZE : LEVEL_SIZE;
+            const uint32_t idx = static_cast<uint32_t>((base >> shift) & (size - 1));
+            if (level > 0 && idx == 0) {
+                // base 同时也是更高层的级联点，保守地停在这里
+                return base;
+            }
+            for (uint32_t s = idx; s < size; ++s) {
+                if (!bucketEmpty(level, s)) {
+                    return base + (static_cast<uint64_t>(s - idx) << shift);
+                }
+            }
+            // 本层剩余部分为空，下一个工作点不早于本层回绕（即上一层的级联点）
+            const uint64_t wrap = (base | ((static_cast<uint64_t>(size) << shift) - 1)) + 1;
+            for (uint32_t s = 0; s < idx; ++s) {
+                if (!bucketEmpty(level, s)) {
+                    return wrap;
+                }
+            }
+            base = wrap;
+        }
+        return base;
+    }
+
+    void apply(TimerCommand<T>& cmd) {
+        const uint32_t idx = static_cast<uint32_t>(cmd.id);
+        if (cmd.op == TimerCommand<T>::ADD) {
+            // 节点已由 schedule_at 取得，此时只有拥有者访问
+            TimerNode& n = node(idx);
+            n.expires = cmd.expires;
+            n.payload = std::move(cmd.payload);
+            n.live = true;
+            link(idx);
+            ++live_count_;
+        } else {
+            uint64_t offset;
+            if (idx >= next_fresh_.load(std::memory_order_relaxed) ||
+                segments_[segmentOf(idx, offset)].load(std::memory_order_acquire) == nullptr) {
+                return; // 无效ID
+            }
+            TimerNode& n = node(idx);
+            if (!n.live || n.gen != static_cast<uint32_t>(cmd.id >> 32)) {
+                return; // 已到期、已取消或尚未插入
+            }
+            unlink(idx);
+            releaseSlot(idx);
+            --live_count_;
+        }
+    }
+
+    void drainInbox() {
+        TimerCommand<T> cmd;
+        while (inbox_.dequeue(cmd, owner_thread_id_)) {
+            apply(cmd);
+        }
+    }
+
+public:
+    // owner_thread_id 为拥有者线程在 MPSCQueue 风险指针表中的槽位
+    explicit TimerWheel(uint64_t start_tick = 0, int owner_thread_id = 0)
+        : now_(start_tick),
+          current_(start_tick),
+          owner_thread_id_(owner_thread_id),
+          buckets_(BUCKET_COUNT, NIL) {}
+
+    ~TimerWheel() {
+        // 释放收件箱中尚未处理的命令节点
+        TimerCommand<T> cmd;
+        while (inbox_.dequeue(cmd, owner_thread_id_)) {}
+        for (auto& seg : segments_) {
+            delete[] seg.load(std::memory_order_relaxed);
+        }
+    }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // 任意线程：在绝对tick deadline 到期
+    TimerId schedule_at(uint64_t deadline, T payload) {
+        TimerCommand<T> cmd;
+        cmd.op = TimerCommand<T>::ADD;
+        const uint32_t idx = acquireSlot();
+        cmd.id = makeId(idx, node(idx).gen);
+        cmd.expires = deadline;
+        cmd.payload = std::move(payload);
+        TimerId id = cmd.id;
+        inbox_.enqueue(std::move(cmd));
+        return id;
+    }
+
+    // 任意线程：预先分配可容纳 count 个定时器的节点池，避免运行中分配新段
+    void reserve(size_t count) {
+        for (int seg = 0; seg < SEGMENTS; ++seg) {
+            const uint64_t first = ((1ull << seg) - 1) * SEGMENT_BASE; // 本段第一个下标
+            if (first >= count) {
+                break;
+            }
+            ensureSegment(seg);
+        }
+    }
+
+    // 任意线程：相对拥有者最近发布的tick延迟 delay 个tick
+    TimerId schedule_after(uint64_t delay, T payload) {
+        return schedule_at(now_.load(std::memory_order_relaxed) + delay, std::move(payload));
+    }
+
+    // 任意线程：取消定时器
+    void cancel(TimerId id) {
+        TimerCommand<T> cmd;
+        cmd.op = TimerCommand<T>::CANCEL;
+        cmd.id = id;
+        inbox_.enqueue(std::move(cmd));
+    }
+
+    // 拥有者线程：取空收件箱并推进到 now（含），对每个到期定时器调用 on_expire(id, payload)
+    // 返回本次触发的定时器数量
+    template<typename F>
+    size_t advance(uint64_t now, F&& on_expire) {
+        drainInbox();
+
+        size_t fired = 0;
+        while (current_ <= now) {
+            if (live_count_ == 0) {
+                // 没有待处理定时器，直接跳到目标tick
+                current_ = now + 1;
+                break;
+            }
+
+            const uint32_t root = static_cast<uint32_t>(current_ & ROOT_MASK);
+            if (root == 0) {
+                for (int level = 1; level < LEVELS; ++level) {
+                    cascade(level);
+                    const int slot_shift = ROOT_BITS + (level - 1) * LEVEL_BITS;
+                    if (((current_ >> slot_shift) & LEVEL_MASK) != 0) {
+                        break;
+                    }
+                }
+            }
+
+            if (buckets_[root] == NIL) {
+                const uint64_t next = nextWorkTick();
+                current_ = next < now + 1 ? next : now + 1;
+                continue;
+            }
+
+            uint32_t idx = detachBucket(root);
+            while (idx != NIL) {
+                TimerNode& n = node(idx);
+                uint32_t next = n.next;
+                if (n.expires > current_) {
+                    link(idx); // 防御性处理：未到期则重新放置
+                } else {
+                    on_expire(makeId(idx, n.gen), n.payload);
+                    releaseSlot(idx);
+                    --live_count_;
+                    ++fired;
+                }
+                idx = next;
+            }
+            ++current_;
+        }
+
+        now_.store(current_ > 0 ? current_ - 1 : 0, std::memory_order_relaxed);
+        return fired;
+    }
+
+    // 拥有者线程：只处理收件箱，不推进时间
+    void poll() {
+        drainInbox();
+    }
+
+    // 拥有者线程：时间轮中的定时器数量（不含收件箱中尚未处理的命令）
+    size_t size() const {
+        return live_count_;
+    }
+
+    // 任意线程：拥有者最近一次推进到的tick
+    uint64_t now() const {
+        return now_.load(std::memory_order_relaxed);
+    }
+};
+
+#endif